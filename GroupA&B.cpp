@@ -1,5 +1,7 @@
 #include <iostream>
 #include <vector>
+#include <iomanip>
+#include <algorithm>
 #include "BlackScholes.hpp"
 #include "PutCallParity.hpp"
 #include "MeshGenerator.hpp"
@@ -9,6 +11,7 @@
 #include "NumericalGreeks.hpp"
 #include "AmericanOptions.hpp"
 #include "AmericanOptionMatrix.hpp"
+#include "IncrementalPricer.hpp"
 
 int main() {
     // Part a: Price options for Batch 1 to Batch 4
@@ -265,5 +268,102 @@ int main() {
     print_value_matrix(american_put_matrix, r_mesh, sig_mesh, "r", "Sigma", "Put Price");
     
 
+    // Part e: Tick-driven incremental repricing
+    std::cout << "\n=== Part e: Incremental Repricing ===\n";
+    {
+        K_mesh = MeshGenerator::linear_mesh(90.0, 110.0, 5.0);
+        r = 0.05, b = 0.05;
+
+        // Random-walk S and sig together from (100, sig0) by up to S_step (relative)
+        // and sig_step per tick, stepping time by dT, and compare every served
+        // price with the exact one
+        auto run_ladder = [&](const std::string& label, double T0, double dT, double sig0,
+                              double S_step, double sig_step, int n_ticks) {
+            double S = 100.0, T = T0, sig = sig0;
+            IncrementalPricer pricer;
+            pricer.set_sample_every(1);
+            std::vector<std::size_t> handles;
+            for (double K : K_mesh) {
+                handles.push_back(pricer.add_contract("C" + std::to_string(int(K)), K, r, b, true));
+                handles.push_back(pricer.add_contract("P" + std::to_string(int(K)), K, r, b, false));
+            }
+
+            double max_diff = 0.0;
+            std::vector<IncrementalPricer::Tick> ticks(handles.size());
+            for (int tick = 0; tick < n_ticks; ++tick) {
+                for (std::size_t i = 0; i < handles.size(); ++i) {
+                    ticks[i] = {handles[i], S, T, sig};
+                }
+                auto prices = pricer.price_batch(ticks);
+
+                for (std::size_t i = 0; i < K_mesh.size(); ++i) {
+                    double exact_C = BlackScholes::call_price(S, K_mesh[i], T, r, sig, b);
+                    double exact_P = BlackScholes::put_price(S, K_mesh[i], T, r, sig, b);
+                    max_diff = std::max({max_diff, fabs(prices[2 * i] - exact_C), fabs(prices[2 * i + 1] - exact_P)});
+                }
+
+                double step = ((tick * 7919) % 11 - 5) / 5.0;
+                S *= 1.0 + S_step * step;
+                sig += sig_step * step;
+                T -= dT;
+            }
+
+            const auto& stats = pricer.stats();
+            std::cout << "\n" << label << ":\n";
+            std::cout << std::fixed << std::setprecision(4)
+                      << "Hits: " << stats.hits << ", Misses: " << stats.misses
+                      << ", Hit rate: " << stats.hit_rate() << "\n";
+            std::cout << std::scientific << std::setprecision(3)
+                      << "Worst estimated error: " << stats.worst_estimated_error << "\n"
+                      << "Worst observed error (" << stats.sampled_hits << " sampled hits): "
+                      << stats.worst_observed_error << "\n"
+                      << "Max difference vs exact: " << max_diff << "\n";
+            std::cout << "Within max_error: "
+                      << (max_diff <= pricer.thresholds().max_error ? "Yes" : "No") << "\n";
+        };
+
+        double minute = 1.0 / (365.0 * 24.0 * 60.0);
+        run_ladder("Mid-dated ladder, T=0.5, minute ticks", 0.5, minute, 0.25, 0.001, 0.00005, 200);
+        run_ladder("Near-expiry ladder, T=2 days, 10 minute ticks", 2.0 / 365.0, 10.0 * minute, 0.25, 0.001, 0.00005, 240);
+        run_ladder("Large time steps, T=1.5 days, 0.9 day ticks", 1.5 / 365.0, 0.9 / 365.0, 0.25, 0.001, 0.00005, 2);
+
+        // Low vol near the money: from each cached point, move S and sig together
+        // and against each other across the whole bounds box
+        IncrementalPricer pricer;
+        pricer.set_sample_every(1);
+        const auto& bounds = pricer.thresholds();
+        std::size_t call = pricer.add_contract("C100", 100.0, 0.032, 0.0, true);
+        std::size_t put = pricer.add_contract("P100", 100.0, 0.032, 0.0, false);
+        double max_diff = 0.0;
+        for (double S0 = 99.0; S0 <= 101.0; S0 += 0.1) {
+            for (double sig0 : {0.05, 0.053, 0.07, 0.1}) {
+                for (int i = -4; i <= 4; ++i) {
+                    for (int j = -4; j <= 4; ++j) {
+                        double S1 = S0 * (1.0 + bounds.max_rel_dS * i / 4.0);
+                        double sig1 = sig0 + bounds.max_dsig * j / 4.0;
+                        double T0 = 0.72, T1 = T0 - 0.00048;
+                        for (std::size_t h : {call, put}) {
+                            pricer.invalidate(h);
+                            pricer.price(h, S0, T0, sig0);
+                            double served = pricer.price(h, S1, T1, sig1);
+                            double exact = h == call ? BlackScholes::call_price(S1, 100.0, T1, 0.032, sig1, 0.0)
+                                                     : BlackScholes::put_price(S1, 100.0, T1, 0.032, sig1, 0.0);
+                            max_diff = std::max(max_diff, fabs(served - exact));
+                        }
+                    }
+                }
+            }
+        }
+
+        const auto& stats = pricer.stats();
+        std::cout << "\nLow-vol bounds sweep, K=100, sig in [0.05, 0.1]:\n";
+        std::cout << "Hits: " << stats.hits << ", Misses: " << stats.misses << "\n";
+        std::cout << std::scientific << std::setprecision(3)
+                  << "Worst observed error (" << stats.sampled_hits << " sampled hits): "
+                  << stats.worst_observed_error << "\n"
+                  << "Max difference vs exact: " << max_diff << "\n";
+        std::cout << "Within max_error: " << (max_diff <= bounds.max_error ? "Yes" : "No") << "\n";
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,307 @@
+#pragma once
+#include <cmath>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/math/distributions/normal.hpp>
+#include "BlackScholes.hpp"
+
+// Tick-driven repricing cache for European options.
+// Each contract keeps its last exact evaluation (price, delta, gamma, vega, theta).
+// Small moves in S, sig or T are priced with a Taylor expansion around that point;
+// once a move or the estimated truncation error crosses a threshold the contract
+// is repriced exactly and the cache is refreshed.
+class IncrementalPricer {
+public:
+    // Bounds on how far inputs may drift from the cached point
+    struct Thresholds {
+        double max_rel_dS = 0.005;          // |dS| / S
+        double max_dsig = 0.005;            // absolute volatility move
+        double max_dT = 1.0 / 365.0;        // years
+        double max_rel_dT = 0.1;            // |dT| / T, keeps steps small near expiry
+        double max_error = 1e-4;            // bound on the served price error
+        double error_safety = 2.0;          // multiplier on the truncation estimate, covers the fourth order terms it omits
+    };
+
+    // Market update for one contract, addressed by the handle from add_contract
+    struct Tick {
+        std::size_t handle;
+        double S;
+        double T;
+        double sig;
+    };
+
+    struct Stats {
+        std::size_t hits = 0;               // Taylor updates served
+        std::size_t misses = 0;             // exact reprices
+        std::size_t sampled_hits = 0;       // hits checked against an exact price
+        double worst_estimated_error = 0.0; // largest error estimate (with safety) accepted on a hit
+        double worst_observed_error = 0.0;  // largest |served - exact| over sampled hits
+
+        double hit_rate() const {
+            std::size_t total = hits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+        }
+    };
+
+    IncrementalPricer() = default;
+
+    explicit IncrementalPricer(const Thresholds& thresholds)
+        : thresholds_(thresholds) {}
+
+    // Register a contract and return its handle; it is priced exactly on its first tick.
+    // Registering an existing id replaces the contract and keeps its handle.
+    std::size_t add_contract(const std::string& id, double K, double r, double b, bool is_call) {
+        Entry entry;
+        entry.K = K;
+        entry.r = r;
+        entry.b = b;
+        entry.is_call = is_call;
+
+        auto it = handles_.find(id);
+        if (it != handles_.end()) {
+            entries_[it->second] = entry;
+            return it->second;
+        }
+        entries_.push_back(entry);
+        handles_[id] = entries_.size() - 1;
+        return entries_.size() - 1;
+    }
+
+    // Look up the handle of a registered contract
+    std::size_t handle(const std::string& id) const {
+        auto it = handles_.find(id);
+        if (it == handles_.end()) {
+            throw std::invalid_argument("Unknown contract: " + id);
+        }
+        return it->second;
+    }
+
+    // Change rate and cost of carry; the next tick reprices exactly
+    void set_rates(std::size_t handle, double r, double b) {
+        Entry& entry = find_entry(handle);
+        entry.r = r;
+        entry.b = b;
+        entry.valid = false;
+    }
+
+    // Force an exact reprice on the next tick
+    void invalidate(std::size_t handle) {
+        find_entry(handle).valid = false;
+    }
+
+    // Price a single contract
+    double price(std::size_t handle, double S, double T, double sig) {
+        check_inputs(S, T, sig);
+        Entry& entry = find_entry(handle);
+        return price_entry(entry, S, T, sig);
+    }
+
+    // Price a set of ticks. Every tick is validated before any is priced,
+    // so a bad tick leaves the cache and the stats untouched.
+    std::vector<double> price_batch(const std::vector<Tick>& ticks) {
+        for (const Tick& tick : ticks) {
+            check_inputs(tick.S, tick.T, tick.sig);
+            find_entry(tick.handle);
+        }
+
+        std::vector<double> prices;
+        prices.reserve(ticks.size());
+        for (const Tick& tick : ticks) {
+            prices.push_back(price_entry(entries_[tick.handle], tick.S, tick.T, tick.sig));
+        }
+        return prices;
+    }
+
+    // Check every Nth hit against an exact price to track served error (0 = off)
+    void set_sample_every(std::size_t n) { sample_every_ = n; }
+
+    const Stats& stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats(); }
+
+    void set_thresholds(const Thresholds& thresholds) { thresholds_ = thresholds; }
+    const Thresholds& thresholds() const { return thresholds_; }
+
+private:
+    // Price, first order Greeks and the higher order terms used by the error estimate.
+    // theta is -dV/dT; the other time derivatives are taken with respect to T
+    // (time to expiry) with no sign flip.
+    struct Evaluation {
+        double price = 0.0, delta = 0.0, gamma = 0.0, vega = 0.0, theta = 0.0;
+        double vanna = 0.0, volga = 0.0, charm = 0.0, veta = 0.0, d2V_dT2 = 0.0;
+        double speed = 0.0, zomma = 0.0, dvanna_dsig = 0.0, ultima = 0.0, color = 0.0;
+    };
+
+    struct Entry {
+        double K = 0.0, r = 0.0, b = 0.0;
+        bool is_call = true;
+
+        // Point of the last exact evaluation
+        bool valid = false;
+        double S = 0.0, T = 0.0, sig = 0.0;
+        double price = 0.0, delta = 0.0, gamma = 0.0, vega = 0.0, theta = 0.0;
+
+        // |coefficient| of each dropped term, named by the moves it multiplies
+        // (s = dS, v = dsig, t = dT), with the 1/2 and 1/6 factors folded in
+        double sv = 0.0, st = 0.0, vv = 0.0, vt = 0.0, tt = 0.0;
+        double sss = 0.0, ssv = 0.0, svv = 0.0, vvv = 0.0, sst = 0.0;
+    };
+
+    Entry& find_entry(std::size_t handle) {
+        if (handle >= entries_.size()) {
+            throw std::invalid_argument("Unknown contract handle");
+        }
+        return entries_[handle];
+    }
+
+    double price_entry(Entry& entry, double S, double T, double sig) {
+        double value;
+        if (try_taylor(entry, S, T, sig, value)) {
+            return value;
+        }
+        store(entry, S, T, sig, evaluate(S, entry.K, T, entry.r, sig, entry.b, entry.is_call));
+        return entry.price;
+    }
+
+    // Expired or degenerate inputs have no Black-Scholes expansion
+    static void check_inputs(double S, double T, double sig) {
+        if (!(S > 0.0) || !(T > 0.0) || !(sig > 0.0)) {
+            throw std::invalid_argument("S, T and sig must be positive");
+        }
+    }
+
+    // Exact evaluation sharing d1, d2 and the normal terms across price and Greeks
+    static Evaluation evaluate(double S, double K, double T, double r, double sig, double b, bool is_call) {
+        boost::math::normal_distribution<> normal(0.0, 1.0);
+        double sqrtT = sqrt(T);
+        double d1 = BlackScholes::calculate_d1(S, K, T, r, sig, b);
+        double d2 = BlackScholes::calculate_d2(d1, sig, T);
+        double carry = exp((b - r) * T);
+        double disc = exp(-r * T);
+        double nd1 = boost::math::pdf(normal, d1);
+
+        Evaluation ev;
+        // rate term of dV/dT: r K e^(-rT) N(d2) for calls, -r K e^(-rT) N(-d2) for puts
+        double rate_term;
+        if (is_call) {
+            double Nd1 = boost::math::cdf(normal, d1);
+            double Nd2 = boost::math::cdf(normal, d2);
+            ev.price = S * carry * Nd1 - K * disc * Nd2;
+            ev.delta = carry * Nd1;
+            rate_term = r * K * disc * Nd2;
+        } else {
+            double Nmd1 = boost::math::cdf(normal, -d1);
+            double Nmd2 = boost::math::cdf(normal, -d2);
+            ev.price = K * disc * Nmd2 - S * carry * Nmd1;
+            ev.delta = -carry * Nmd1;
+            rate_term = -r * K * disc * Nmd2;
+        }
+        ev.gamma = carry * nd1 / (S * sig * sqrtT);
+        ev.vega = S * carry * nd1 * sqrtT;
+
+        double decay = ev.vega * sig / (2.0 * T);
+        ev.theta = -(decay + (b - r) * S * ev.delta + rate_term);
+
+        double dd1_dT = (b + sig * sig / 2.0) / (sig * sqrtT) - d1 / (2.0 * T);
+        double dd2_dT = dd1_dT - sig / (2.0 * sqrtT);
+        ev.vanna = -carry * nd1 * d2 / sig;
+        ev.volga = ev.vega * d1 * d2 / sig;
+        ev.charm = (b - r) * ev.delta + carry * nd1 * dd1_dT;
+        ev.veta = ev.vega * ((b - r) - d1 * dd1_dT + 1.0 / (2.0 * T));
+        ev.d2V_dT2 = sig / (2.0 * T) * (ev.veta - ev.vega / T)
+                     + (b - r) * S * ev.charm
+                     - r * rate_term + r * S * carry * nd1 * dd2_dT;
+
+        ev.speed = -ev.gamma / S * (d1 / (sig * sqrtT) + 1.0);
+        ev.zomma = ev.gamma * (d1 * d2 - 1.0) / sig;
+        ev.dvanna_dsig = -carry * nd1 * (d1 * d2 * d2 - d1 - d2) / (sig * sig);
+        ev.ultima = -ev.vega / (sig * sig) * (d1 * d2 * (1.0 - d1 * d2) + d1 * d1 + d2 * d2);
+        ev.color = ev.gamma * ((b - r) - d1 * dd1_dT - 1.0 / (2.0 * T));
+        return ev;
+    }
+
+    void store(Entry& e, double S, double T, double sig, const Evaluation& ev) {
+        ++stats_.misses;
+        e.valid = true;
+        e.S = S;
+        e.T = T;
+        e.sig = sig;
+        e.price = ev.price;
+        e.delta = ev.delta;
+        e.gamma = ev.gamma;
+        e.vega = ev.vega;
+        e.theta = ev.theta;
+
+        e.sv = fabs(ev.vanna);
+        e.st = fabs(ev.charm);
+        e.vv = 0.5 * fabs(ev.volga);
+        e.vt = fabs(ev.veta);
+        e.tt = 0.5 * fabs(ev.d2V_dT2);
+        e.sss = fabs(ev.speed) / 6.0;
+        e.ssv = 0.5 * fabs(ev.zomma);
+        e.svv = 0.5 * fabs(ev.dvanna_dsig);
+        e.vvv = fabs(ev.ultima) / 6.0;
+        e.sst = 0.5 * fabs(ev.color);
+    }
+
+    // Second order Taylor update: delta/gamma in S, vega in sig, theta in time
+    static double taylor_price(const Entry& e, double dS, double dT, double dsig) {
+        return e.price + e.delta * dS + 0.5 * e.gamma * dS * dS
+               + e.vega * dsig - e.theta * dT;
+    }
+
+    // Terms dropped by taylor_price: the second order terms involving sig or T
+    // (vanna, volga, charm, veta, d2V/dT2), every third order term in S and sig
+    // (speed, zomma, dVanna/dsig, ultima) and color for gamma decay
+    static double error_estimate(const Entry& e, double dS, double dT, double dsig) {
+        double a = fabs(dS), v = fabs(dsig), t = fabs(dT);
+        return a * (e.sv * v + e.st * t + a * (e.sss * a + e.ssv * v + e.sst * t))
+               + v * (e.vv * v + e.vt * t + v * (e.svv * a + e.vvv * v))
+               + e.tt * t * t;
+    }
+
+    bool within_bounds(const Entry& e, double dS, double dT, double dsig) const {
+        return fabs(dS) <= thresholds_.max_rel_dS * e.S &&
+               fabs(dsig) <= thresholds_.max_dsig &&
+               fabs(dT) <= thresholds_.max_dT &&
+               fabs(dT) <= thresholds_.max_rel_dT * e.T;
+    }
+
+    bool try_taylor(Entry& e, double S, double T, double sig, double& value) {
+        if (!e.valid) {
+            return false;
+        }
+
+        double dS = S - e.S;
+        double dT = T - e.T;
+        double dsig = sig - e.sig;
+        if (!within_bounds(e, dS, dT, dsig)) {
+            return false;
+        }
+
+        double err = thresholds_.error_safety * error_estimate(e, dS, dT, dsig);
+        if (err > thresholds_.max_error) {
+            return false;
+        }
+
+        value = taylor_price(e, dS, dT, dsig);
+        ++stats_.hits;
+        stats_.worst_estimated_error = std::max(stats_.worst_estimated_error, err);
+
+        if (sample_every_ != 0 && stats_.hits % sample_every_ == 0) {
+            double exact = e.is_call ? BlackScholes::call_price(S, e.K, T, e.r, sig, e.b)
+                                     : BlackScholes::put_price(S, e.K, T, e.r, sig, e.b);
+            ++stats_.sampled_hits;
+            stats_.worst_observed_error = std::max(stats_.worst_observed_error, fabs(value - exact));
+        }
+        return true;
+    }
+
+    Thresholds thresholds_;
+    Stats stats_;
+    std::size_t sample_every_ = 0;
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, std::size_t> handles_;
+};